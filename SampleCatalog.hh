@@ -0,0 +1,126 @@
+#ifndef SAMPLECATALOG_HH
+#define SAMPLECATALOG_HH
+
+#include "TString.h"
+#include "TCut.h"
+#include "TChain.h"
+#include <vector>
+#include <cassert>
+#include <stdio.h>
+
+#include "OptimizationConstants.hh"
+
+//
+// Catalog of all samples used in the tuning and in the plots:
+// the ntupler output that is converted into flat ntuples, and the
+// flat ntuples themselves. Scripts look samples up by name here
+// instead of hardcoding file names and weights.
+//
+namespace Samples {
+
+  // Input samples contain true and fake electrons and are split
+  // at conversion, signal and background are selected by the truth cuts
+  enum SampleRole   {ROLE_INPUT, ROLE_SIGNAL, ROLE_BACKGROUND};
+  enum SampleRegion {REGION_BARREL, REGION_ENDCAP, REGION_ALLETA};
+
+  const TString ntuplerDir      = "/user/tomc/eleIdTuning/tuples/";
+  const TString ntuplerTreeName = "ntupler/ElectronTree";
+  const TString flatTreeName    = "electronTree";
+
+  struct Sample {
+    TString name;
+    std::vector<TString> files;
+    TString treeName;
+    SampleRole role;
+    TString weight;              // per-electron weight expression
+    SampleRegion region;
+    bool kinematicReweighting;   // true electrons get pt-eta weights at conversion
+    TString stitchReference;     // sample this one is stitched to, empty if none
+    float genPtMin;              // generated pt range of flat pt samples,
+    float genPtMax;              // used for the stitching normalization
+    // Constructor
+    Sample(TString nameIn, std::vector<TString> filesIn, TString treeNameIn, SampleRole roleIn,
+           TString weightIn, SampleRegion regionIn, bool kinematicReweightingIn = false,
+           TString stitchReferenceIn = "", float genPtMinIn = 0, float genPtMaxIn = 0):
+      name(nameIn), files(filesIn), treeName(treeNameIn), role(roleIn),
+      weight(weightIn), region(regionIn), kinematicReweighting(kinematicReweightingIn),
+      stitchReference(stitchReferenceIn), genPtMin(genPtMinIn), genPtMax(genPtMaxIn){};
+  };
+
+  inline const std::vector<Sample*> & getCatalog(){
+    static const std::vector<Sample*> catalog = {
+      // Ntupler output, converted by convert_EventStrNtuple_To_FlatNtuple.C
+      new Sample("DY",                     {ntuplerDir + "DY.root"},                     ntuplerTreeName, ROLE_INPUT, "genWeight", REGION_ALLETA, true),
+      new Sample("TT",                     {ntuplerDir + "TT.root"},                     ntuplerTreeName, ROLE_INPUT, "genWeight", REGION_ALLETA),
+      new Sample("GJ",                     {ntuplerDir + "GJ.root"},                     ntuplerTreeName, ROLE_INPUT, "genWeight", REGION_ALLETA),
+      new Sample("DoubleEleFlat1to300",    {ntuplerDir + "DoubleEleFlat1to300.root"},    ntuplerTreeName, ROLE_INPUT, "genWeight", REGION_ALLETA,
+                 false, "",                    1,   300),
+      new Sample("DoubleEleFlat300to6500", {ntuplerDir + "DoubleEleFlat300to6500.root"}, ntuplerTreeName, ROLE_INPUT, "genWeight", REGION_ALLETA,
+                 false, "DoubleEleFlat1to300", 300, 6500),
+
+      // Flat ntuples for plotting, the stitching and kinematic weights are in kinWeight
+      new Sample("DY_signal", {Opt::tagDir + "/DY_flat_ntuple_trueAndFake_alleta_full.root"}, flatTreeName, ROLE_SIGNAL,     "genWeight*kinWeight", REGION_ALLETA),
+      new Sample("DY_fakes",  {Opt::tagDir + "/DY_flat_ntuple_trueAndFake_alleta_full.root"}, flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_ALLETA),
+      new Sample("TT_fakes",  {Opt::tagDir + "/TT_flat_ntuple_trueAndFake_alleta_full.root"}, flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_ALLETA),
+      new Sample("GJ_fakes",  {Opt::tagDir + "/GJ_flat_ntuple_trueAndFake_alleta_full.root"}, flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_ALLETA),
+
+      // Spring16 flat ntuples, used for the HLT-safe plots
+      new Sample("DYJetsToLL_jun14_signal", {"DYJetsToLL_jun14_flat_ntuple_trueAndFake_barrel_full.root"}, flatTreeName, ROLE_SIGNAL,     "genWeight*kinWeight", REGION_BARREL),
+      new Sample("DYJetsToLL_jun14_signal", {"DYJetsToLL_jun14_flat_ntuple_trueAndFake_endcap_full.root"}, flatTreeName, ROLE_SIGNAL,     "genWeight*kinWeight", REGION_ENDCAP),
+      new Sample("DYJetsToLL_jun14_fakes",  {"DYJetsToLL_jun14_flat_ntuple_trueAndFake_barrel_full.root"}, flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_BARREL),
+      new Sample("DYJetsToLL_jun14_fakes",  {"DYJetsToLL_jun14_flat_ntuple_trueAndFake_endcap_full.root"}, flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_ENDCAP),
+      new Sample("TTJets_may29_fakes",      {"TTJets_may29_flat_ntuple_full_barrel.root"},                 flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_BARREL),
+      new Sample("TTJets_may29_fakes",      {"TTJets_may29_flat_ntuple_full_endcap.root"},                 flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_ENDCAP),
+      new Sample("GJet_jun14_fakes",        {"GJet_jun14_flat_ntuple_trueAndFake_alleta_full.root"},       flatTreeName, ROLE_BACKGROUND, "genWeight*kinWeight", REGION_ALLETA)
+    };
+    return catalog;
+  }
+
+  // Look up a sample by name. If there is no version of the sample
+  // for the requested region, fall back to the one covering all eta.
+  inline const Sample * getSample(TString name, SampleRegion region = REGION_ALLETA){
+    const Sample *fallback = 0;
+    for(auto sample : getCatalog()){
+      if( sample->name != name ) continue;
+      if( sample->region == region ) return sample;
+      if( sample->region == REGION_ALLETA ) fallback = sample;
+    }
+    if( !fallback ){
+      printf("Sample %s is not found in the catalog\n", name.Data());
+      assert(0);
+    }
+    return fallback;
+  }
+
+  // Truth matching cuts selecting the electrons of the sample
+  inline TCut getTruthCut(const Sample *sample){
+    if( sample->role == ROLE_SIGNAL )     return Opt::trueEleCut;
+    if( sample->role == ROLE_BACKGROUND ) return Opt::fakeEleCut;
+    return "";
+  }
+
+  inline Long64_t getEntries(const Sample *sample){
+    TChain chain(sample->treeName);
+    for(auto file : sample->files) chain.Add(file);
+    return chain.GetEntries();
+  }
+
+  // Samples generated flat in pt are stitched to their reference sample
+  // by the ratio of the generated pt ranges and of the event counts
+  inline float getStitchingFactor(const Sample *sample){
+    if( sample->stitchReference == "" ) return 1.;
+    const Sample *reference = getSample(sample->stitchReference, sample->region);
+    float ptRangeRatio = (sample->genPtMax - sample->genPtMin)/(reference->genPtMax - reference->genPtMin);
+    return ptRangeRatio*getEntries(reference)/getEntries(sample);
+  }
+
+  // Full weight expression, including the stitching normalization
+  inline TString getWeightExpression(const Sample *sample){
+    float stitchingFactor = getStitchingFactor(sample);
+    if( stitchingFactor == 1. ) return sample->weight;
+    return TString::Format("(%s)*%.8g", sample->weight.Data(), stitchingFactor);
+  }
+
+};
+
+#endif
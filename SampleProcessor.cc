@@ -0,0 +1,152 @@
+#include "SampleProcessor.hh"
+
+#include "TROOT.h"
+#include "TFile.h"
+#include "RVersion.h"
+#include "ROOT/RDataFrame.hxx"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+#include "ROOT/RDFHelpers.hxx"
+#endif
+#include <memory>
+#include <string>
+
+using namespace Samples;
+
+namespace {
+
+  TString getHistogramKey(TString sampleName, TString varName){
+    return sampleName + ":" + varName;
+  }
+
+  // Samples reading the same tree from the same files share one pass
+  TString getInputKey(const Sample *sample){
+    TString key = sample->treeName;
+    for(auto file : sample->files) key += ":" + file;
+    return key;
+  }
+
+  // All files of the sample can be opened and contain its tree
+  bool isReadable(const Sample *sample){
+    for(auto fileName : sample->files){
+      TFile *file = TFile::Open(fileName);
+      bool hasTree = file && !file->IsZombie() && file->Get(sample->treeName);
+      delete file;
+      if( !hasTree ){
+        printf("SampleProcessor:: can not read tree %s from file %s\n",
+               sample->treeName.Data(), fileName.Data());
+        return false;
+      }
+    }
+    return true;
+  }
+
+}
+
+SampleProcessor::SampleProcessor(TCut commonCuts, Long64_t maxEntries):
+  _commonCuts(commonCuts), _maxEntries(maxEntries){
+};
+
+void SampleProcessor::addSample(const Sample *sample){
+  _samples.push_back(sample);
+}
+
+void SampleProcessor::addVariable(TString varName, int nbins, float xmin, float xmax){
+  _variables.push_back(HistogramSettings(varName, nbins, xmin, xmax));
+}
+
+void SampleProcessor::process(int nThreads){
+
+  // Histograms of a previous call already belong to the caller
+  _histograms.clear();
+
+  if( _samples.empty() || _variables.empty() ){
+    printf("SampleProcessor:: no samples or no variables to process\n");
+    return;
+  }
+
+  // The thread pool is left to the caller unless a size is requested here
+  if( nThreads >= 0 ) ROOT::EnableImplicitMT(nThreads);
+
+  // Range() is not available with implicit multi-threading
+  if( _maxEntries > 0 && ROOT::IsImplicitMTEnabled() ){
+    printf("SampleProcessor:: maxEntries can not be used with implicit multi-threading,"
+           " call ROOT::DisableImplicitMT() first\n");
+    assert(0);
+  }
+
+  std::map<TString, std::vector<const Sample*>> inputs;
+  for(auto sample : _samples) inputs[getInputKey(sample)].push_back(sample);
+
+  // Book all histograms before any event loop is started
+  std::vector<std::unique_ptr<ROOT::RDataFrame>> frames;
+  std::map<TString, ROOT::RDF::RResultPtr<TH1D>> booked;
+  std::vector<ROOT::RDF::RResultPtr<TH1D>> triggers;
+  int isample = 0;
+  for(auto &input : inputs){
+    const Sample *first = input.second.front();
+
+    // Inputs that can not be read are skipped, their histograms are null
+    if( !isReadable(first) ){
+      for(auto sample : input.second){
+        printf("SampleProcessor:: WARNING: skipping sample %s\n", sample->name.Data());
+        for(auto settings : _variables)
+          _histograms[getHistogramKey(sample->name, settings.varName)] = 0;
+      }
+      continue;
+    }
+
+    std::vector<std::string> fileNames;
+    for(auto file : first->files) fileNames.push_back(file.Data());
+    frames.emplace_back(new ROOT::RDataFrame(first->treeName.Data(), fileNames));
+
+    // Define() keeps the node type, so the plotted variables can be added
+    // to the base frame in place, RNode is not available in older ROOT.
+    ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager> frame = *frames.back();
+    for(uint ivar=0; ivar<_variables.size(); ivar++)
+      frame = frame.Define(TString::Format("plotVar%d", ivar).Data(), _variables.at(ivar).varName.Data());
+
+    for(auto sample : input.second){
+      TString cuts = (_commonCuts && getTruthCut(sample)).GetTitle();
+      if( cuts == "" ) cuts = "true";
+      // Column names are unique per sample, also for samples sharing an input
+      TString weightName = TString::Format("sampleWeight%d", isample++);
+      // A jitted Filter gives the same node type with or without Range()
+      auto selected = (_maxEntries > 0 ? frame.Range(_maxEntries).Filter(cuts.Data())
+                                       : frame.Filter(cuts.Data()))
+                        .Define(weightName.Data(), getWeightExpression(sample).Data());
+
+      for(uint ivar=0; ivar<_variables.size(); ivar++){
+        const HistogramSettings &settings = _variables.at(ivar);
+        TString hname = "h_" + sample->name + "_" + settings.varName;
+        ROOT::RDF::TH1DModel model(hname.Data(), "", settings.nbins, settings.xmin, settings.xmax);
+        booked[getHistogramKey(sample->name, settings.varName)] =
+          selected.Histo1D(model, TString::Format("plotVar%d", ivar).Data(), weightName.Data());
+      }
+    }
+    triggers.push_back(booked[getHistogramKey(first->name, _variables.front().varName)]);
+  }
+
+  // One event loop per input fills all of its histograms
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+  std::vector<ROOT::RDF::RResultHandle> handles(triggers.begin(), triggers.end());
+  if( !handles.empty() ) ROOT::RDF::RunGraphs(handles);
+#else
+  for(auto &trigger : triggers) trigger.GetValue();
+#endif
+
+  for(auto &result : booked){
+    TH1D *hist = (TH1D*)result.second->Clone();
+    hist->SetDirectory(0);
+    _histograms[result.first] = hist;
+  }
+}
+
+TH1D* SampleProcessor::getHistogram(TString sampleName, TString varName){
+  auto result = _histograms.find(getHistogramKey(sampleName, varName));
+  if( result == _histograms.end() ){
+    printf("SampleProcessor:: no histogram of %s for sample %s, was process() called?\n",
+           varName.Data(), sampleName.Data());
+    assert(0);
+  }
+  return result->second;
+}
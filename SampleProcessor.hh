@@ -0,0 +1,64 @@
+#ifndef SAMPLEPROCESSOR_HH
+#define SAMPLEPROCESSOR_HH
+
+#include "TString.h"
+#include "TCut.h"
+#include "TH1D.h"
+#include <map>
+#include <vector>
+
+#include "SampleCatalog.hh"
+
+namespace Samples {
+
+  // Binning of one histogrammed variable (a branch name or an expression)
+  struct HistogramSettings {
+    TString varName;
+    int nbins;
+    float xmin;
+    float xmax;
+    HistogramSettings(TString nameIn, int nbinsIn, float xminIn, float xmaxIn) :
+      varName(nameIn), nbins(nbinsIn), xmin(xminIn), xmax(xmaxIn) {};
+  };
+
+  //
+  // Fills weighted histograms of all requested variables for all requested
+  // samples. Each input tree is read once, with all variables and all samples
+  // selected from it filled in the same pass. If the caller has enabled
+  // implicit multi-threading, every thread fills its own copies of the
+  // histograms, merged at the end. The passes over different inputs run
+  // concurrently only with ROOT 6.24 or newer (RunGraphs) and implicit
+  // multi-threading enabled, otherwise they run one after the other.
+  //
+  class SampleProcessor {
+
+  public:
+    // Cuts applied to all samples on top of their truth cuts. A non-zero
+    // maxEntries limits every input to its first entries, this requires
+    // implicit multi-threading to be disabled.
+    SampleProcessor(TCut commonCuts = "", Long64_t maxEntries = 0);
+
+    void addSample(const Sample *sample);
+    void addVariable(TString varName, int nbins, float xmin, float xmax);
+
+    // Run the event loops. By default the implicit multi-threading setting
+    // of the session is used as is, nThreads >= 0 enables it with that
+    // many threads (0 lets ROOT choose).
+    void process(int nThreads = -1);
+
+    // Histograms are available after process() and are owned by the caller,
+    // who deletes them when done. Every call to process() fills a new set.
+    // Samples whose input files or tree can not be read give a null pointer.
+    TH1D* getHistogram(TString sampleName, TString varName);
+
+  private:
+    TCut     _commonCuts;
+    Long64_t _maxEntries;
+    std::vector<const Sample*>      _samples;
+    std::vector<HistogramSettings>  _variables;
+    std::map<TString, TH1D*>        _histograms;
+  };
+
+};
+
+#endif